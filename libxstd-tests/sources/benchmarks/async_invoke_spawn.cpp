@@ -0,0 +1,100 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Benchmark of the cost of asynchronously invoking an empty callable
+// and waiting for its result. `xstd::async_invoke` spawns a new thread
+// for every call, whereas `xstd::pooled_async_invoke`, `task_thread`
+// and `thread_pool` reuse their threads. Additionally, bursts of calls
+// that block for a short time are started at once to compare spawning
+// threads with the overflow policies of a bounded `async_pool`.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t calls = 10'000;
+
+constexpr std::size_t bursts     = 100;
+constexpr std::size_t burst_size = 64;
+constexpr auto blocking_time     = std::chrono::microseconds{100};
+
+auto measure(auto&& call) -> double {
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < calls; ++i) call();
+  const auto stop = clock_type::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         calls;
+}
+
+auto measure_bursts(auto&& call) -> double {
+  std::vector<std::future<void>> futures{};
+  futures.reserve(burst_size);
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < bursts; ++i) {
+    for (std::size_t j = 0; j < burst_size; ++j) futures.push_back(call());
+    for (auto& future : futures) future.get();
+    futures.clear();
+  }
+  const auto stop = clock_type::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (bursts * burst_size);
+}
+
+void blocking_work() { std::this_thread::sleep_for(blocking_time); }
+
+void run_bursts(std::string_view method, xstd::async_overflow_policy policy) {
+  xstd::async_pool pool{std::max(std::thread::hardware_concurrency(), 1u),
+                        policy};
+  std::print("{},{},{:.1f}\n", method, bursts * burst_size,
+             measure_bursts([&] { return pool.async_invoke(blocking_work); }));
+}
+
+}  // namespace
+
+int main() {
+  std::print("method,calls,ns_per_call\n");
+  std::print("async_invoke,{},{:.1f}\n", calls, measure([] {
+               return xstd::async_invoke([] { return 1; }).get();
+             }));
+  std::print("pooled_async_invoke,{},{:.1f}\n", calls, measure([] {
+               return xstd::pooled_async_invoke([] { return 1; }).get();
+             }));
+  std::print("jthread,{},{:.1f}\n", calls,
+             measure([] { std::jthread{[] {}}.join(); }));
+  {
+    xstd::task_thread thread{};
+    std::print("task_thread,{},{:.1f}\n", calls, measure([&] {
+                 return thread.async_invoke([] { return 1; }).get();
+               }));
+  }
+  {
+    xstd::thread_pool pool{};
+    std::print("thread_pool,{},{:.1f}\n", calls, measure([&] {
+                 return pool.async_invoke([] { return 1; }).get();
+               }));
+  }
+  std::print("async_invoke_burst,{},{:.1f}\n", bursts * burst_size,
+             measure_bursts([] { return xstd::async_invoke(blocking_work); }));
+  run_bursts("async_pool_spawn_burst", xstd::async_overflow_policy::spawn);
+  run_bursts("async_pool_enqueue_burst", xstd::async_overflow_policy::enqueue);
+  run_bursts("async_pool_run_inline_burst",
+             xstd::async_overflow_policy::run_inline);
+}
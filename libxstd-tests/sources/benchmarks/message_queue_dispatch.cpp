@@ -0,0 +1,109 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Benchmark of pushing and processing a closed set of message types.
+// The `message_queue` stores the messages as `std::variant` inside
+// its ring buffer and dispatches them by `match`. The type-erased
+// baseline pushes a task for every message to a ring task queue whose
+// tasks receive the state of the consumer as parameter.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t batch_size = 512;
+constexpr std::size_t batches    = 2'000;
+
+struct state {
+  std::int64_t sum{};
+  std::size_t characters{};
+};
+
+struct add {
+  std::int64_t value{};
+};
+struct subtract {
+  std::int64_t value{};
+};
+struct relabel {
+  std::array<char, 24> name{};
+};
+
+constexpr relabel label{{'x', 's', 't', 'd'}};
+
+auto measure(auto&& batch) -> double {
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < batches; ++i) batch(i);
+  const auto stop = clock_type::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (batches * batch_size);
+}
+
+}  // namespace
+
+int main() {
+  std::print("queue,messages,ns_per_message\n");
+  {
+    xstd::message_queue<add, subtract, relabel> messages{batch_size};
+    state s{};
+    const auto handler = xstd::match{
+        [&](add& m) { s.sum += m.value; },
+        [&](subtract& m) { s.sum -= m.value; },
+        [&](relabel& m) { s.characters += std::strlen(m.name.data()); },
+    };
+    const auto time = measure([&](std::size_t i) {
+      for (std::size_t j = 0; j < batch_size; ++j) {
+        const auto value = static_cast<std::int64_t>(i + j);
+        if (j % 3 == 0)
+          messages.push(add{value});
+        else if (j % 3 == 1)
+          messages.push(subtract{value});
+        else
+          messages.push(label);
+      }
+      messages.process_all(handler);
+    });
+    std::print("message_queue,{},{:.1f}\n", batches * batch_size, time);
+  }
+  {
+    xstd::basic_ring_task_queue<state&> tasks{batch_size};
+    state s{};
+    const auto time = measure([&](std::size_t i) {
+      for (std::size_t j = 0; j < batch_size; ++j) {
+        const auto value = static_cast<std::int64_t>(i + j);
+        if (j % 3 == 0)
+          tasks.push_and_discard([m = add{value}](state& target) {
+            target.sum += m.value;
+          });
+        else if (j % 3 == 1)
+          tasks.push_and_discard([m = subtract{value}](state& target) {
+            target.sum -= m.value;
+          });
+        else
+          tasks.push_and_discard([m = label](state& target) {
+            target.characters += std::strlen(m.name.data());
+          });
+      }
+      tasks.process_all(s);
+    });
+    std::print("type_erased_tasks,{},{:.1f}\n", batches * batch_size, time);
+  }
+}
@@ -0,0 +1,107 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Latency benchmark of urgent tasks under load.
+// A background producer keeps a backlog of bulk tasks, each busy for a
+// fixed duration, in the queue of a task thread. Meanwhile, urgent tasks
+// are pushed periodically and the time from enqueuing to their invocation
+// is measured. A FIFO task thread is compared to a priority task thread
+// and an earliest-deadline-first task thread.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using namespace std::chrono_literals;
+
+constexpr std::size_t urgent_tasks = 1000;
+constexpr std::size_t bulk_backlog = 64;
+constexpr auto bulk_work           = 20us;
+constexpr auto urgent_period       = 200us;
+
+void spin_for(clock_type::duration duration) {
+  const auto stop = clock_type::now() + duration;
+  while (clock_type::now() < stop);
+}
+
+auto percentile(std::vector<double>& samples, double p) -> double {
+  const auto index = static_cast<std::size_t>(p * (samples.size() - 1));
+  std::ranges::nth_element(samples, samples.begin() + index);
+  return samples[index];
+}
+
+void run(std::string_view queue, auto& thread, auto push_urgent) {
+  std::atomic<std::size_t> backlog{};
+  std::jthread loader{[&](std::stop_token stop_token) {
+    while (not stop_token.stop_requested()) {
+      if (backlog.load(std::memory_order_relaxed) >= bulk_backlog) {
+        std::this_thread::yield();
+        continue;
+      }
+      backlog.fetch_add(1, std::memory_order_relaxed);
+      thread.push_and_discard([&] {
+        spin_for(bulk_work);
+        backlog.fetch_sub(1, std::memory_order_release);
+      });
+    }
+  }};
+
+  std::vector<double> latencies(urgent_tasks);
+  for (auto& latency : latencies) {
+    std::this_thread::sleep_for(urgent_period);
+    const auto start = clock_type::now();
+    push_urgent(thread, [&latency, start] {
+      latency = std::chrono::duration<double, std::micro>(clock_type::now() -
+                                                          start)
+                    .count();
+    }).get();
+  }
+  loader.request_stop();
+  loader.join();
+  // Queued bulk tasks refer to the local backlog counter.
+  // So, wait for them to finish before leaving the scope.
+  while (backlog.load(std::memory_order_acquire) != 0)
+    std::this_thread::yield();
+
+  std::print("{},{},{:.1f},{:.1f},{:.1f}\n", queue, urgent_tasks,
+             percentile(latencies, 0.5), percentile(latencies, 0.99),
+             std::ranges::max(latencies));
+}
+
+}  // namespace
+
+int main() {
+  std::print("queue,urgent_tasks,p50_us,p99_us,max_us\n");
+  {
+    xstd::task_thread thread{};
+    run("fifo", thread, [](auto& t, auto f) { return t.push(std::move(f)); });
+  }
+  {
+    xstd::priority_task_thread thread{};
+    run("priority", thread,
+        [](auto& t, auto f) { return t.push(7, std::move(f)); });
+  }
+  {
+    xstd::deadline_task_thread thread{};
+    run("deadline", thread, [](auto& t, auto f) {
+      return t.push_with_deadline(clock_type::now() + 100us, std::move(f));
+    });
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Single-threaded benchmark of the enqueuing overhead of task queues.
+// A batch of empty tasks is pushed with different enqueuing operations
+// and processed afterwards on the same thread. The time per task is
+// measured separately for pushing and processing. Thus, contention plays
+// no role and only the costs of type erasure, packaging, and shared states
+// are compared. The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t tasks_per_batch = 10'000;
+constexpr std::size_t batches         = 20;
+
+void run(std::string_view queue_name,
+         std::string_view operation,
+         auto& tasks,
+         auto&& push) {
+  double push_time    = 0;
+  double process_time = 0;
+  for (std::size_t batch = 0; batch < batches; ++batch) {
+    const auto start = clock_type::now();
+    for (std::size_t i = 0; i < tasks_per_batch; ++i) push(tasks);
+    const auto middle = clock_type::now();
+    tasks.process_all();
+    const auto stop = clock_type::now();
+    push_time +=
+        std::chrono::duration<double, std::nano>(middle - start).count();
+    process_time +=
+        std::chrono::duration<double, std::nano>(stop - middle).count();
+  }
+  const auto total = tasks_per_batch * batches;
+  std::print("{},{},{},{:.1f},{:.1f}\n", queue_name, operation, total,
+             push_time / total, process_time / total);
+}
+
+void run(std::string_view queue_name, auto& tasks) {
+  run(queue_name, "push_and_discard", tasks,
+      [](auto& tasks) { tasks.push_and_discard([] {}); });
+  // The futures are dropped directly as only the enqueuing costs matter.
+  run(queue_name, "push", tasks,
+      [](auto& tasks) { std::ignore = tasks.push([] { return 1; }); });
+  run(queue_name, "push_task_future", tasks, [](auto& tasks) {
+    std::ignore = tasks.push(xstd::use_task_future, [] { return 1; });
+  });
+}
+
+}  // namespace
+
+int main() {
+  std::print("queue,operation,tasks,push_ns_per_task,process_ns_per_task\n");
+  {
+    xstd::task_queue tasks{};
+    run("task_queue", tasks);
+  }
+  {
+    xstd::inplace_task_queue tasks{};
+    run("inplace_task_queue", tasks);
+  }
+}
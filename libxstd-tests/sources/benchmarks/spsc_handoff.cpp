@@ -0,0 +1,64 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Throughput benchmark of a single producer handing off tasks
+// to a single `task_thread`, as between two stages of a pipeline.
+// The producer enqueues small tasks as fast as possible and waits
+// until all of them have been processed. The SPSC ring buffer is
+// compared to the MPSC queue and the mutex-based queue.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t tasks = 1'000'000;
+
+template <typename thread_type>
+void run(std::string_view queue_name,
+         std::string_view strategy_name,
+         xstd::wait_strategy strategy,
+         auto&&... args) {
+  thread_type thread{strategy, std::forward<decltype(args)>(args)...};
+  std::size_t count = 0;
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < tasks; ++i)
+    thread.async_invoke_and_discard([&count] { ++count; });
+  const auto processed = thread.invoke([&count] { return count; });
+  const auto stop = clock_type::now();
+  std::print("{},{},{},{:.1f}\n", queue_name, strategy_name, processed,
+             std::chrono::duration<double, std::nano>(stop - start).count() /
+                 tasks);
+}
+
+void run(std::string_view strategy_name, xstd::wait_strategy strategy) {
+  run<xstd::spsc_task_thread>("spsc", strategy_name, strategy, 4096);
+  run<xstd::task_thread>("mpsc", strategy_name, strategy);
+  run<xstd::basic_task_thread<xstd::task_queue>>("mutex", strategy_name,
+                                                 strategy);
+}
+
+}  // namespace
+
+int main() {
+  std::print("queue,wait_strategy,tasks,ns_per_task\n");
+  run("park", xstd::wait_strategy::park());
+  run("spin_then_park", xstd::wait_strategy::spin_then_park());
+}
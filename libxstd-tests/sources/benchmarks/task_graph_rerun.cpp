@@ -0,0 +1,97 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Re-execution benchmark of a `task_graph` on a `thread_pool`.
+// Graphs of empty nodes are declared once and run repeatedly such that
+// the measured time per node is the overhead of dependency tracking and
+// scheduling. Chains measure inline continuations, layers of nodes with
+// all-to-all edges between consecutive layers measure fan-out and fan-in.
+// As a baseline, layers are also executed by waiting for the
+// `std::future`s of all nodes of a layer before starting the next.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t runs = 1'000;
+
+auto measure(std::size_t nodes, auto&& run) -> double {
+  for (std::size_t i = 0; i < runs / 10; ++i) run();
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < runs; ++i) run();
+  const auto stop = clock_type::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (runs * nodes);
+}
+
+void chain(xstd::thread_pool& pool, std::size_t nodes) {
+  xstd::task_graph graph{};
+  auto previous = graph.emplace([] {});
+  for (std::size_t i = 1; i < nodes; ++i) {
+    const auto node = graph.emplace([] {});
+    graph.precede(previous, node);
+    previous = node;
+  }
+  std::print("task_graph,chain,{},{},{:.1f}\n", pool.size(), nodes,
+             measure(nodes, [&] { graph.run(pool); }));
+}
+
+void layers(xstd::thread_pool& pool, std::size_t depth, std::size_t width) {
+  xstd::task_graph graph{};
+  std::vector<xstd::task_graph::node_id> previous{}, current{};
+  for (std::size_t i = 0; i < depth; ++i) {
+    current.clear();
+    for (std::size_t j = 0; j < width; ++j) {
+      current.push_back(graph.emplace([] {}));
+      for (const auto node : previous) graph.precede(node, current.back());
+    }
+    std::swap(previous, current);
+  }
+  const auto nodes = depth * width;
+  std::print("task_graph,layers_{}x{},{},{},{:.1f}\n", depth, width,
+             pool.size(), nodes, measure(nodes, [&] { graph.run(pool); }));
+
+  std::vector<std::future<void>> futures{};
+  futures.reserve(width);
+  std::print("futures,layers_{}x{},{},{},{:.1f}\n", depth, width, pool.size(),
+             nodes, measure(nodes, [&] {
+               for (std::size_t i = 0; i < depth; ++i) {
+                 futures.clear();
+                 for (std::size_t j = 0; j < width; ++j)
+                   futures.push_back(pool.async_invoke([] {}));
+                 for (auto& future : futures) future.wait();
+               }
+             }));
+}
+
+}  // namespace
+
+int main() {
+  const std::size_t threads =
+      std::max(std::thread::hardware_concurrency(), 1u);
+  std::print("executor,graph,workers,nodes,ns_per_node\n");
+  for (std::size_t workers = 1; workers <= threads; workers *= 2) {
+    xstd::thread_pool pool{workers};
+    chain(pool, 1000);
+    layers(pool, 10, 8);
+    layers(pool, 4, 64);
+  }
+}
@@ -0,0 +1,89 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Contention benchmark of the task queue backends.
+// A given number of producers pushes empty fire-and-forget tasks
+// while a given number of consumers concurrently waits for and
+// processes them. The measured time starts when all threads are ready
+// and ends when the last task has been processed.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+constexpr std::size_t tasks_per_producer = 200'000;
+constexpr std::size_t ring_capacity      = 1024;
+
+template <typename queue>
+auto throughput(queue& tasks, std::size_t producers, std::size_t consumers)
+    -> double {
+  const auto total = producers * tasks_per_producer;
+  std::atomic<std::size_t> remaining{total};
+  std::latch ready{static_cast<std::ptrdiff_t>(producers + consumers + 1)};
+
+  std::vector<std::jthread> threads{};
+  for (std::size_t i = 0; i < consumers; ++i)
+    threads.emplace_back([&](std::stop_token stop_token) {
+      ready.arrive_and_wait();
+      while (tasks.wait_and_process(stop_token))
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          remaining.notify_all();
+    });
+  for (std::size_t i = 0; i < producers; ++i)
+    threads.emplace_back([&] {
+      ready.arrive_and_wait();
+      for (std::size_t j = 0; j < tasks_per_producer; ++j)
+        tasks.push_and_discard([] {});
+    });
+
+  ready.arrive_and_wait();
+  const auto start = std::chrono::steady_clock::now();
+  for (auto r = remaining.load(); r != 0; r = remaining.load())
+    remaining.wait(r);
+  const auto stop = std::chrono::steady_clock::now();
+
+  for (auto& thread : threads) thread.request_stop();
+  threads.clear();
+
+  const auto seconds = std::chrono::duration<double>(stop - start).count();
+  return total / seconds;
+}
+
+void run(std::string_view backend, auto make_queue) {
+  const std::size_t threads =
+      std::max(std::thread::hardware_concurrency(), 2u);
+  for (std::size_t producers = 1; producers <= 2 * threads; producers *= 2)
+    for (std::size_t consumers = 1; consumers <= threads / 2; consumers *= 2) {
+      auto tasks = make_queue();
+      const auto result = throughput(*tasks, producers, consumers);
+      std::print("{},{},{},{},{:.0f}\n", backend, producers, consumers,
+                 producers * tasks_per_producer, result);
+    }
+}
+
+}  // namespace
+
+int main() {
+  std::print("backend,producers,consumers,tasks,tasks_per_second\n");
+  run("mutex", [] { return std::make_unique<xstd::task_queue>(); });
+  run("sharded", [] { return std::make_unique<xstd::sharded_task_queue>(); });
+  run("mpmc_ring", [] {
+    return std::make_unique<xstd::ring_task_queue>(ring_capacity);
+  });
+}
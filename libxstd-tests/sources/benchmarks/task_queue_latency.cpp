@@ -0,0 +1,105 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Latency benchmark of the task queue backends.
+// A given number of producers pushes tasks that record the time
+// from their enqueuing to their invocation, while a given number of
+// consumers concurrently waits for and processes them. Every producer
+// keeps a bounded number of tasks in flight such that the measured
+// latency reflects the queue and not an unboundedly growing backlog.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t tasks_per_producer = 20'000;
+constexpr std::size_t tasks_in_flight    = 32;
+constexpr std::size_t ring_capacity      = 1024;
+
+auto percentile(std::vector<std::int64_t>& samples, double p)
+    -> std::int64_t {
+  const auto index = static_cast<std::size_t>(p * (samples.size() - 1));
+  std::ranges::nth_element(samples, samples.begin() + index);
+  return samples[index];
+}
+
+template <typename queue>
+auto latencies(queue& tasks, std::size_t producers, std::size_t consumers)
+    -> std::vector<std::int64_t> {
+  std::vector<std::int64_t> result(producers * tasks_per_producer);
+  std::latch ready{static_cast<std::ptrdiff_t>(producers + consumers + 1)};
+  std::latch done{static_cast<std::ptrdiff_t>(producers)};
+
+  std::vector<std::jthread> threads{};
+  for (std::size_t i = 0; i < consumers; ++i)
+    threads.emplace_back([&](std::stop_token stop_token) {
+      ready.arrive_and_wait();
+      while (tasks.wait_and_process(stop_token));
+    });
+  for (std::size_t i = 0; i < producers; ++i)
+    threads.emplace_back([&, i] {
+      std::atomic<std::size_t> in_flight{};
+      ready.arrive_and_wait();
+      for (std::size_t j = 0; j < tasks_per_producer; ++j) {
+        while (in_flight.load(std::memory_order_acquire) >= tasks_in_flight)
+          std::this_thread::yield();
+        in_flight.fetch_add(1, std::memory_order_relaxed);
+        tasks.push_and_discard([&, index = i * tasks_per_producer + j,
+                                start = clock_type::now()] {
+          result[index] = (clock_type::now() - start).count();
+          in_flight.fetch_sub(1, std::memory_order_release);
+        });
+      }
+      // The tasks refer to the local counter of in-flight tasks.
+      while (in_flight.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+      done.count_down();
+    });
+
+  ready.arrive_and_wait();
+  done.wait();
+  for (auto& thread : threads) thread.request_stop();
+  threads.clear();
+  return result;
+}
+
+void run(std::string_view backend, auto make_queue) {
+  const std::size_t threads =
+      std::max(std::thread::hardware_concurrency(), 2u);
+  for (std::size_t producers = 1; producers <= threads; producers *= 2)
+    for (std::size_t consumers = 1; consumers <= threads / 2; consumers *= 2) {
+      auto tasks  = make_queue();
+      auto result = latencies(*tasks, producers, consumers);
+      std::print("{},{},{},{},{},{},{}\n", backend, producers, consumers,
+                 result.size(), percentile(result, 0.5),
+                 percentile(result, 0.99), std::ranges::max(result));
+    }
+}
+
+}  // namespace
+
+int main() {
+  std::print("backend,producers,consumers,tasks,p50_ns,p99_ns,max_ns\n");
+  run("mutex", [] { return std::make_unique<xstd::task_queue>(); });
+  run("mpmc_ring", [] {
+    return std::make_unique<xstd::ring_task_queue>(ring_capacity);
+  });
+}
@@ -0,0 +1,77 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Round-trip benchmark of synchronous invocations on a `task_thread`.
+// The calling thread enqueues an empty task and blocks until its result
+// is available. Round trips of `invoke`, which keeps the result slot
+// and the queue node on the caller's stack, are compared to round trips
+// through `std::future`, as formerly used by `invoke`, and through the
+// pooled `task_future`. The `invoke` of a bare `mpsc_task_queue` shows
+// the overhead of the task thread itself. All of them are measured
+// for different wait strategies of the processing thread.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t round_trips = 100'000;
+
+auto measure(auto&& round_trip) -> double {
+  // Warm up the thread and the pools of shared states.
+  for (std::size_t i = 0; i < round_trips / 10; ++i) round_trip();
+  const auto start = clock_type::now();
+  for (std::size_t i = 0; i < round_trips; ++i) round_trip();
+  const auto stop = clock_type::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         round_trips;
+}
+
+void run(std::string_view strategy_name, xstd::wait_strategy strategy) {
+  xstd::task_thread thread{strategy};
+  std::print("invoke,{},{},{:.1f}\n", strategy_name, round_trips,
+             measure([&] { return thread.invoke([] { return 1; }); }));
+  std::print("future,{},{},{:.1f}\n", strategy_name, round_trips,
+             measure([&] {
+               return thread.async_invoke([] { return 1; }).get();
+             }));
+  std::print("task_future,{},{},{:.1f}\n", strategy_name, round_trips,
+             measure([&] {
+               return thread.async_invoke(xstd::use_task_future, [] {
+                 return 1;
+               }).get();
+             }));
+
+  xstd::mpsc_task_queue tasks{};
+  tasks.set_wait_strategy(strategy);
+  std::jthread worker{[&](std::stop_token stop_token) {
+    tasks.run(stop_token);
+  }};
+  std::print("queue_invoke,{},{},{:.1f}\n", strategy_name, round_trips,
+             measure([&] { return tasks.invoke([] { return 1; }); }));
+}
+
+}  // namespace
+
+int main() {
+  std::print("operation,wait_strategy,round_trips,ns_per_round_trip\n");
+  run("park", xstd::wait_strategy::park());
+  run("spin_then_park", xstd::wait_strategy::spin_then_park());
+}
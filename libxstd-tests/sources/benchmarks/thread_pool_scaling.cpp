@@ -0,0 +1,81 @@
+// Copyright © 2026 Markus Pawellek
+//
+// This file is part of `xstd`.
+//
+// `xstd` is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// `xstd` is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with `xstd`. If not, see <https://www.gnu.org/licenses/>.
+//
+import std;
+import xstd;
+
+// Scaling benchmark of the work-stealing `thread_pool` for skewed tasks.
+// A single task spawns all other tasks from inside the pool such that
+// they end up in the deque of one worker and must be stolen by the others.
+// The work of every task is drawn from a heavy-tailed distribution.
+// The results are printed as CSV to the standard output.
+//
+namespace {
+
+constexpr std::size_t task_count = 20'000;
+
+/// Burn CPU cycles without being optimized away.
+///
+auto work(std::size_t iterations) -> std::uint64_t {
+  std::uint64_t x = iterations;
+  for (std::size_t i = 0; i < iterations; ++i)
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+  return x;
+}
+
+auto skewed_sizes() -> std::vector<std::size_t> {
+  std::mt19937 rng{12345};
+  std::exponential_distribution<double> distribution{1.0};
+  std::vector<std::size_t> sizes(task_count);
+  for (auto& size : sizes)
+    size = 200 + static_cast<std::size_t>(2000 * std::pow(distribution(rng), 3));
+  return sizes;
+}
+
+auto measure(std::size_t workers, const std::vector<std::size_t>& sizes)
+    -> double {
+  xstd::thread_pool pool{workers};
+  std::atomic<std::uint64_t> checksum{};
+  std::latch done{static_cast<std::ptrdiff_t>(sizes.size())};
+  const auto start = std::chrono::steady_clock::now();
+  pool.async_invoke_and_discard([&] {
+    for (const auto size : sizes)
+      pool.async_invoke_and_discard([&, size] {
+        checksum.fetch_add(work(size), std::memory_order_relaxed);
+        done.count_down();
+      });
+  });
+  done.wait();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+}  // namespace
+
+int main() {
+  const auto sizes = skewed_sizes();
+  const std::size_t threads =
+      std::max(std::thread::hardware_concurrency(), 1u);
+  std::print("workers,tasks,seconds,speedup\n");
+  const auto baseline = measure(1, sizes);
+  std::print("{},{},{:.6f},{:.3f}\n", 1, sizes.size(), baseline, 1.0);
+  for (std::size_t workers = 2; workers <= threads; workers *= 2) {
+    const auto seconds = measure(workers, sizes);
+    std::print("{},{},{:.6f},{:.3f}\n", workers, sizes.size(), seconds,
+               baseline / seconds);
+  }
+}
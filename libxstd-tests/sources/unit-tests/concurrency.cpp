@@ -1,6 +1,6 @@
 #include <doctest/doctest.h>
-//
-#include <xstd/concurrency.hpp>
+import std;
+import xstd;
 
 SCENARIO("xstd::task_bind") {
   {
@@ -105,3 +105,1551 @@ SCENARIO("xstd::basic_task_queue") {
     thread.join();
   }
 }
+
+SCENARIO("xstd::basic_ring_task_queue") {
+  {
+    std::array<bool, 100> data{};
+    xstd::basic_ring_task_queue<> tasks{16};
+    CHECK(tasks.process() == false);
+    auto setter = [&](int index) { data[index] = true; };
+    std::jthread producer1{[&] {
+      for (size_t i = 0; i < data.size(); i += 2)
+        tasks.async_invoke_and_discard(setter, i);
+    }};
+    std::jthread producer2{[&] {
+      for (size_t i = 1; i < data.size(); i += 2)
+        tasks.async_invoke_and_discard(setter, i);
+    }};
+    std::stop_source stop_source{};
+    std::jthread consumer1{[&] { tasks.run(stop_source.get_token()); }};
+    std::jthread consumer2{[&] { tasks.run(stop_source.get_token()); }};
+    producer1.join();
+    producer2.join();
+    auto done = tasks.async_invoke([] { return 42; });
+    CHECK(done.get() == 42);
+    stop_source.request_stop();
+    consumer1.join();
+    consumer2.join();
+    tasks.process_all();
+    CHECK(std::all_of(data.begin(), data.end(), [](bool x) { return x; }));
+  }
+  {
+    using data_type = std::array<bool, 10>;
+    xstd::basic_ring_task_queue<data_type&> tasks{4};
+    auto setter = [&](data_type& data, int index) { data[index] = true; };
+    data_type data{};
+    for (size_t i = 0; i < data.size(); ++i) {
+      tasks.async_invoke_and_discard(setter, i);
+      tasks.process_all(data);
+    }
+    CHECK(std::all_of(data.begin(), data.end(), [](bool x) { return x; }));
+  }
+}
+
+SCENARIO("xstd::basic_sharded_task_queue") {
+  {
+    // Tasks of multiple producers are processed by multiple consumers.
+    constexpr int count = 10'000;
+    xstd::sharded_task_queue tasks{4};
+    CHECK(tasks.get_container().size() == 4);
+    CHECK(tasks.process() == false);
+    std::atomic<int> processed{};
+    std::vector<std::jthread> producers{};
+    for (int p = 0; p < 4; ++p)
+      producers.emplace_back([&] {
+        for (int i = 0; i < count; ++i)
+          tasks.push_and_discard([&] { ++processed; });
+      });
+    std::stop_source stop_source{};
+    std::jthread consumer1{[&] { tasks.run(stop_source.get_token()); }};
+    std::jthread consumer2{[&] { tasks.run(stop_source.get_token()); }};
+    producers.clear();
+    CHECK(tasks.invoke([] { return 42; }) == 42);
+    stop_source.request_stop();
+    consumer1.join();
+    consumer2.join();
+    tasks.process_all();
+    CHECK(processed == 4 * count);
+  }
+  {
+    // Tasks pushed by the same thread keep their order
+    // and parameters are passed as for `basic_task_queue`.
+    using data_type = std::vector<int>;
+    xstd::basic_sharded_task_queue<data_type&> tasks{};
+    for (int i = 0; i < 100; ++i)
+      tasks.async_invoke_and_discard(
+          [](data_type& data, int x) { data.push_back(x); }, i);
+    std::jthread other{[&] {
+      tasks.push_and_discard([](data_type& data) { data.push_back(-1); });
+    }};
+    other.join();
+    data_type data{};
+    tasks.process_all(data);
+    CHECK(data.size() == 101);
+    std::erase(data, -1);
+    std::vector<int> expected(100);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(data == expected);
+  }
+  {
+    xstd::sharded_task_queue tasks{2};
+    int invoked = 0;
+    for (int i = 0; i < 10; ++i) tasks.push_and_discard([&] { ++invoked; });
+    CHECK(tasks.cancel_if([](auto&) { return true; }) == 10);
+    tasks.process_all();
+    CHECK(invoked == 0);
+  }
+}
+
+SCENARIO("xstd::thread_pool") {
+  {
+    xstd::thread_pool pool{4};
+    CHECK(pool.size() == 4);
+    CHECK(not pool.is_worker());
+    std::vector<std::future<int>> results{};
+    for (int i = 0; i < 100; ++i)
+      results.push_back(pool.async_invoke([](int x) { return x * x; }, i));
+    for (int i = 0; i < 100; ++i) CHECK(results[i].get() == i * i);
+    CHECK(pool.invoke([](int x, int y) { return x + y; }, 1, 2) == 3);
+    CHECK(pool.invoke<float>([] { return 1; }) == 1.0f);
+  }
+  {
+    // Tasks submitted by a worker go to its local deque and are
+    // stolen by the other workers. Nested invocations run inline.
+    xstd::thread_pool pool{4};
+    std::atomic<int> counter{};
+    std::latch done{100};
+    pool.async_invoke_and_discard([&] {
+      CHECK(pool.is_worker());
+      for (int i = 0; i < 100; ++i)
+        pool.async_invoke_and_discard([&] {
+          counter += pool.invoke([] { return 1; });
+          done.count_down();
+        });
+    });
+    done.wait();
+    CHECK(counter == 100);
+  }
+}
+
+SCENARIO("xstd::context_pool") {
+  {
+    // Every worker passes its own context to the tasks it processes.
+    struct scratch {
+      std::size_t index{};
+      std::thread::id owner = std::this_thread::get_id();
+      std::vector<int> buffer{};
+    };
+    xstd::context_pool<scratch> pool{
+        4, [](std::size_t i) { return scratch{.index = i}; }};
+    CHECK(pool.size() == 4);
+    CHECK(not pool.is_worker());
+    std::vector<std::future<bool>> results{};
+    for (int i = 0; i < 100; ++i)
+      results.push_back(pool.async_invoke(
+          [](scratch& s, int x) {
+            s.buffer.assign(x, x);
+            return s.owner == std::this_thread::get_id() && s.index < 4;
+          },
+          i));
+    for (auto& result : results) CHECK(result.get());
+    CHECK(pool.invoke([](scratch& s, int x) { return s.index + x; }, 10) >= 10);
+    // Nested invocations use the context of the calling worker.
+    CHECK(pool.async_invoke([&](scratch& s) {
+                return pool.invoke([](scratch& t) { return &t; }) == &s;
+              })
+              .get());
+  }
+  {
+    // Draining processes all enqueued tasks with the workers' contexts.
+    xstd::context_pool<int, xstd::basic_sharded_task_queue<int&>> pool{2};
+    std::atomic<int> count{};
+    for (int i = 0; i < 1000; ++i)
+      pool.async_invoke_and_discard([&](int& local) {
+        ++local;
+        ++count;
+      });
+    pool.drain_and_stop();
+    CHECK(count == 1000);
+  }
+  {
+    // A failing construction of a context stops all workers.
+    const auto make = [](std::size_t i) {
+      if (i == 2) throw std::runtime_error{"no connection"};
+      return std::size_t{i};
+    };
+    CHECK_THROWS_AS((xstd::context_pool<std::size_t>{4, make}),
+                    std::runtime_error);
+  }
+}
+
+SCENARIO("xstd::inplace_task") {
+  {
+    xstd::inplace_task<int(int)> task{};
+    CHECK(not task);
+    task = [](int x) { return 2 * x; };
+    CHECK(task);
+    CHECK(task(2) == 4);
+    auto other = std::move(task);
+    CHECK(not task);
+    CHECK(other(3) == 6);
+    other.reset();
+    CHECK(not other);
+  }
+  {
+    // Small callables are stored inline, large ones on the heap.
+    struct small {
+      std::array<std::byte, 64> data;
+      void operator()() {}
+    };
+    struct large {
+      std::array<std::byte, 65> data;
+      void operator()() {}
+    };
+    static_assert(xstd::inplace_task<void()>::stores_inplace<small>);
+    static_assert(not xstd::inplace_task<void()>::stores_inplace<large>);
+    static_assert(xstd::inplace_task<void(), 128>::stores_inplace<large>);
+
+    auto counter = std::make_shared<int>(0);
+    std::array<std::byte, 256> padding{};
+    xstd::inplace_task<void()> task = [counter, padding] { ++*counter; };
+    auto other = std::move(task);
+    other();
+    CHECK(*counter == 1);
+    CHECK(counter.use_count() == 2);
+    other.reset();
+    CHECK(counter.use_count() == 1);
+  }
+  {
+    xstd::inplace_task_queue tasks{};
+    int sum = 0;
+    for (int i = 0; i < 10; ++i)
+      tasks.async_invoke_and_discard([&sum](int x) { sum += x; }, i);
+    auto result = tasks.async_invoke([] { return 42; });
+    tasks.process_all();
+    CHECK(sum == 45);
+    CHECK(result.get() == 42);
+  }
+  {
+    using data_type = std::array<bool, 10>;
+    xstd::basic_inplace_task_queue<32, data_type&> tasks{};
+    auto setter = [&](data_type& data, int index) { data[index] = true; };
+    for (size_t i = 0; i < data_type{}.size(); ++i)
+      tasks.async_invoke_and_discard(setter, i);
+    data_type data{};
+    tasks.process_all(data);
+    CHECK(std::all_of(data.begin(), data.end(), [](bool x) { return x; }));
+  }
+}
+
+SCENARIO("xstd::basic_task_queue bulk operations") {
+  {
+    std::vector<int> data(100);
+    std::vector<std::function<void()>> setters{};
+    for (size_t i = 0; i < data.size(); ++i)
+      setters.push_back([&data, i] { data[i] = i; });
+    xstd::task_queue tasks{};
+    tasks.push_bulk(setters);
+    CHECK(setters.size() == data.size());
+    CHECK(tasks.process_batch(10) == 10);
+    CHECK(data[9] == 9);
+    CHECK(data[10] == 0);
+    CHECK(tasks.process_batch(1000) == 90);
+    CHECK(tasks.process_batch(1000) == 0);
+    for (size_t i = 0; i < data.size(); ++i) CHECK(data[i] == i);
+  }
+  {
+    // The ring buffer is smaller than the bulk and, hence,
+    // the producer blocks until the consumer made some progress.
+    xstd::ring_task_queue tasks{16};
+    std::stop_source stop_source{};
+    std::jthread consumer{
+        [&] { tasks.run_batched(stop_source.get_token(), 32); }};
+    auto results = tasks.async_invoke_bulk([](int x) { return x * x; },
+                                           std::views::iota(0, 100));
+    CHECK(results.size() == 100);
+    for (int i = 0; i < 100; ++i) CHECK(results[i].get() == i * i);
+    stop_source.request_stop();
+  }
+  {
+    using data_type = std::array<int, 10>;
+    xstd::basic_task_queue<data_type&> tasks{};
+    auto results = tasks.async_invoke_bulk(
+        [](data_type& data, int i) { return data[i] = i; },
+        std::vector{1, 2, 3});
+    data_type data{};
+    std::stop_source stop_source{};
+    CHECK(tasks.wait_and_process_batch(stop_source.get_token(), 2, data) ==
+          2);
+    CHECK(tasks.wait_and_process_batch(stop_source.get_token(), 2, data) ==
+          1);
+    stop_source.request_stop();
+    CHECK(tasks.wait_and_process_batch(stop_source.get_token(), 2, data) ==
+          0);
+    constexpr data_type expected{0, 1, 2, 3};
+    CHECK(data == expected);
+    CHECK(results[2].get() == 3);
+  }
+}
+
+SCENARIO("xstd::task_future") {
+  {
+    xstd::task_promise<int> promise{};
+    auto future = promise.get_future();
+    CHECK(future.valid());
+    CHECK(not future.is_ready());
+    CHECK_THROWS_AS(promise.get_future(), std::future_error);
+    promise.set_value(42);
+    CHECK(future.is_ready());
+    CHECK(future.get() == 42);
+    CHECK(not future.valid());
+  }
+  {
+    xstd::task_future<void> future{};
+    {
+      xstd::task_promise<void> promise{};
+      future = promise.get_future();
+    }
+    CHECK(future.is_ready());
+    CHECK_THROWS_AS(future.get(), std::future_error);
+  }
+  {
+    xstd::task_thread thread{};
+    auto error = thread.async_invoke(xstd::use_task_future, [] {
+      throw std::runtime_error{"task failed"};
+    });
+    CHECK_THROWS_AS(error.get(), std::runtime_error);
+    // Shared states are recycled across many round trips.
+    for (int i = 0; i < 1000; ++i) {
+      auto result = thread.async_invoke(
+          xstd::use_task_future, [](int x) { return x + 1; }, i);
+      CHECK(result.get() == i + 1);
+    }
+  }
+  {
+    xstd::basic_task_queue<int> tasks{};
+    auto future = tasks.push(xstd::use_task_future,
+                             [](int x) { return std::to_string(x); });
+    int x = 0;
+    auto ref = tasks.push(xstd::use_task_future, [&x](int) -> int& { return x; });
+    CHECK(tasks.process(7));
+    CHECK(tasks.process(7));
+    CHECK(future.get() == "7");
+    CHECK(&ref.get() == &x);
+  }
+}
+
+SCENARIO("xstd::priority_task_queue and xstd::deadline_task_queue") {
+  {
+    std::vector<int> order{};
+    xstd::priority_task_queue tasks{};
+    tasks.push_and_discard([&] { order.push_back(0); });
+    tasks.push_and_discard(2, [&] { order.push_back(2); });
+    tasks.push_and_discard(1, [&] { order.push_back(1); });
+    tasks.push_and_discard(2, [&] { order.push_back(3); });
+    // Priorities beyond the highest level are clamped.
+    auto result = tasks.push(100, [&] {
+      order.push_back(4);
+      return 4;
+    });
+    tasks.process_all();
+    CHECK(result.get() == 4);
+    CHECK(order == std::vector{4, 2, 3, 1, 0});
+  }
+  {
+    using namespace std::chrono_literals;
+    std::vector<int> order{};
+    xstd::deadline_task_queue tasks{};
+    const auto now = std::chrono::steady_clock::now();
+    tasks.push_and_discard([&] { order.push_back(0); });
+    tasks.push_and_discard(now + 2s, [&] { order.push_back(2); });
+    auto result =
+        tasks.push_with_deadline(now + 1s, [&] { order.push_back(1); });
+    tasks.push_and_discard(now + 2s, [&] { order.push_back(3); });
+    tasks.process_all();
+    result.get();
+    CHECK(order == std::vector{1, 2, 3, 0});
+  }
+  {
+    xstd::priority_task_thread thread{};
+    auto low  = thread.push([] { return 1; });
+    auto high = thread.push(7, [] { return 2; });
+    CHECK(low.get() + high.get() == 3);
+    CHECK(thread.invoke([] { return 3; }) == 3);
+  }
+}
+
+SCENARIO("xstd::wait_strategy") {
+  static_assert(xstd::wait_strategy{} == xstd::wait_strategy::park());
+  static_assert(xstd::wait_strategy::spin_then_park(10).spins() == 10);
+  static_assert(xstd::wait_strategy::busy_poll().busy_polling());
+  {
+    xstd::task_queue tasks{};
+    tasks.set_wait_strategy(xstd::wait_strategy::busy_poll());
+    CHECK(tasks.get_wait_strategy() == xstd::wait_strategy::busy_poll());
+    std::stop_source stop_source{};
+    std::jthread stopper{[&] { stop_source.request_stop(); }};
+    // Busy polling must still honor stop requests.
+    CHECK(not tasks.wait_and_process(stop_source.get_token()));
+  }
+  for (auto strategy : {xstd::wait_strategy::park(),
+                        xstd::wait_strategy::spin_then_park(),
+                        xstd::wait_strategy::busy_poll()}) {
+    xstd::task_thread thread{strategy};
+    int sum = 0;
+    for (int i = 1; i <= 100; ++i)
+      sum += thread.invoke([](int x) { return x; }, i);
+    CHECK(sum == 5050);
+    xstd::thread_pool pool{2, strategy};
+    CHECK(pool.invoke([] { return 1; }) == 1);
+  }
+  {
+    xstd::ring_task_queue tasks{16};
+    tasks.set_wait_strategy(xstd::wait_strategy::spin_then_park(64));
+    std::stop_source stop_source{};
+    std::jthread consumer{
+        [&] { tasks.run_batched(stop_source.get_token(), 8); }};
+    auto results = tasks.async_invoke_bulk([](int x) { return 2 * x; },
+                                           std::views::iota(0, 50));
+    for (int i = 0; i < 50; ++i) CHECK(results[i].get() == 2 * i);
+    stop_source.request_stop();
+  }
+}
+
+SCENARIO("xstd::task_queue_stats") {
+  {
+    xstd::duration_histogram histogram{};
+    using namespace std::chrono_literals;
+    CHECK(histogram.bucket(0ns) == 0);
+    CHECK(histogram.bucket(1ns) == 1);
+    CHECK(histogram.bucket(1000ns) == 10);
+    CHECK(histogram.bucket(1000h) == histogram.bucket_count - 1);
+    histogram.buckets[3] = 99;
+    histogram.buckets[10] = 1;
+    CHECK(histogram.count() == 100);
+    CHECK(histogram.quantile(0.5) == 8ns);
+    CHECK(histogram.quantile(1.0) == 1024ns);
+  }
+  {
+    xstd::task_queue tasks{};
+    for (int i = 0; i < 10; ++i) tasks.push_and_discard([] {});
+    auto result = tasks.push([] { return 1; });
+    tasks.process();
+    const auto stats = tasks.stats();
+    if constexpr (xstd::instrumentation_enabled) {
+      CHECK(stats.enqueued == 11);
+      CHECK(stats.dequeued == 1);
+      CHECK(stats.depth == 10);
+      CHECK(stats.high_water_mark == 11);
+      CHECK(stats.time_in_queue.count() == 1);
+      CHECK(stats.execution_time.count() == 1);
+    } else {
+      CHECK(stats.enqueued == 0);
+      CHECK(stats.depth == 0);
+    }
+    tasks.process_all();
+    CHECK(result.get() == 1);
+  }
+  {
+    xstd::task_thread thread{};
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    CHECK(thread.invoke([] { return 1; }) == 1);
+    const auto stats = thread.stats();
+    if constexpr (xstd::instrumentation_enabled) {
+      CHECK(stats.dequeued == 1);
+      CHECK(stats.depth == 0);
+      CHECK(stats.idle_time > std::chrono::nanoseconds{0});
+    }
+  }
+}
+
+namespace {
+
+auto square(int x) -> xstd::task<int> { co_return x * x; }
+
+auto fail() -> xstd::task<> {
+  throw std::runtime_error{"coroutine failed"};
+  co_return;
+}
+
+auto hop(xstd::task_thread& first, xstd::task_thread& second)
+    -> xstd::task<std::vector<std::thread::id>> {
+  std::vector<std::thread::id> ids{};
+  co_await first.schedule();
+  ids.push_back(std::this_thread::get_id());
+  co_await second.schedule();
+  ids.push_back(std::this_thread::get_id());
+  co_return ids;
+}
+
+auto sum_of_squares(xstd::thread_pool& pool, int n) -> xstd::task<int> {
+  co_await pool.schedule();
+  int sum = 0;
+  for (int i = 1; i <= n; ++i) sum += co_await square(i);
+  co_return sum;
+}
+
+}  // namespace
+
+SCENARIO("xstd::task coroutines") {
+  CHECK(xstd::sync_wait(square(7)) == 49);
+  CHECK_THROWS_AS(xstd::sync_wait(fail()), std::runtime_error);
+  {
+    xstd::task_thread first{};
+    xstd::task_thread second{};
+    const auto ids = xstd::sync_wait(hop(first, second));
+    CHECK(ids.size() == 2);
+    CHECK(ids[0] == first.get_id());
+    CHECK(ids[1] == second.get_id());
+  }
+  {
+    xstd::thread_pool pool{2};
+    CHECK(xstd::sync_wait(sum_of_squares(pool, 10)) == 385);
+  }
+}
+
+SCENARIO("xstd::task_future continuations") {
+  {
+    // Continuations attached before and after the result is ready.
+    xstd::task_promise<int> promise{};
+    auto future = promise.get_future().then([](int x) { return 2 * x; });
+    promise.set_value(21);
+    CHECK(future.get() == 42);
+    xstd::task_promise<int> ready{};
+    ready.set_value(1);
+    CHECK(ready.get_future().then([](int x) { return x + 1; }).get() == 2);
+  }
+  {
+    // Exceptions are propagated or handed over with the ready future.
+    xstd::task_promise<int> promise{};
+    auto value = promise.get_future().then([](int x) { return x; });
+    promise.set_exception(std::make_exception_ptr(std::runtime_error{""}));
+    CHECK_THROWS_AS(value.get(), std::runtime_error);
+    xstd::task_promise<void> broken{};
+    auto handled = broken.get_future().then([](xstd::task_future<void> f) {
+      try {
+        f.get();
+      } catch (const std::future_error&) {
+        return true;
+      }
+      return false;
+    });
+    { auto discard = std::move(broken); }
+    CHECK(handled.get());
+  }
+  {
+    xstd::task_thread io{};
+    xstd::thread_pool pool{2};
+    auto result = pool.async_invoke(xstd::use_task_future, [] { return 6; })
+                      .then(io, [&](int x) {
+                        CHECK(std::this_thread::get_id() == io.get_id());
+                        return x * 7;
+                      });
+    CHECK(result.get() == 42);
+  }
+  {
+    xstd::thread_pool pool{2};
+    std::vector<xstd::task_future<int>> futures{};
+    for (int i = 0; i < 20; ++i)
+      futures.push_back(
+          pool.async_invoke(xstd::use_task_future, [i] { return i * i; }));
+    auto all = xstd::when_all(std::move(futures));
+    const auto values = all.get();
+    CHECK(values.size() == 20);
+    for (int i = 0; i < 20; ++i) CHECK(values[i] == i * i);
+    CHECK(xstd::when_all(std::vector<xstd::task_future<int>>{}).get().empty());
+  }
+  {
+    std::vector<xstd::task_promise<int>> promises(3);
+    std::vector<xstd::task_future<int>> futures{};
+    for (auto& promise : promises) futures.push_back(promise.get_future());
+    auto any = xstd::when_any(std::move(futures));
+    CHECK(not any.is_ready());
+    promises[1].set_value(7);
+    const auto [index, value] = any.get();
+    CHECK(index == 1);
+    CHECK(value == 7);
+    promises[0].set_value(3);
+    promises[2].set_value(5);
+  }
+  {
+    std::vector<xstd::task_promise<void>> promises(2);
+    std::vector<xstd::task_future<void>> futures{};
+    for (auto& promise : promises) futures.push_back(promise.get_future());
+    auto all = xstd::when_all(std::move(futures));
+    promises[0].set_value();
+    promises[1].set_exception(std::make_exception_ptr(std::logic_error{""}));
+    CHECK_THROWS_AS(all.get(), std::logic_error);
+  }
+}
+
+SCENARIO("xstd::mpsc_queue") {
+  {
+    xstd::mpsc_queue<std::unique_ptr<int>> queue{};
+    std::unique_ptr<int> value{};
+    CHECK(not queue.try_pop(value));
+    for (int i = 0; i < 3; ++i) queue.push(std::make_unique<int>(i));
+    for (int i = 0; i < 3; ++i) {
+      CHECK(queue.try_pop(value));
+      CHECK(*value == i);
+    }
+    CHECK(not queue.try_pop(value));
+    // Remaining elements are destroyed with the queue.
+    queue.push_range(std::views::iota(0, 2) | std::views::transform([](int i) {
+                       return std::make_unique<int>(i);
+                     }));
+  }
+  {
+    // Nodes of the caller are not deleted but their elements are destroyed.
+    using queue_type = xstd::mpsc_queue<std::shared_ptr<int>>;
+    const auto shared = std::make_shared<int>(0);
+    queue_type::node first{std::shared_ptr{shared}};
+    queue_type::node second{std::shared_ptr{shared}};
+    {
+      queue_type queue{};
+      queue.push(first);
+      queue.push(std::make_shared<int>(1));
+      queue.push(second);
+      CHECK(shared.use_count() == 3);
+      std::shared_ptr<int> value{};
+      CHECK(queue.try_pop(value));
+      CHECK(value == shared);
+      CHECK(queue.try_pop(value));
+      CHECK(*value == 1);
+    }
+    CHECK(shared.use_count() == 1);
+  }
+  {
+    constexpr int producers = 4;
+    constexpr int count     = 10'000;
+    xstd::mpsc_queue<int> queue{};
+    std::vector<std::jthread> threads{};
+    for (int p = 0; p < producers; ++p)
+      threads.emplace_back([&, p] {
+        for (int i = 0; i < count; ++i) queue.push(p * count + i);
+      });
+    // Elements of every producer arrive in FIFO order.
+    std::vector<int> last(producers, -1);
+    std::stop_source stop_source{};
+    bool ordered = true;
+    for (int i = 0; i < producers * count; ++i) {
+      int value;
+      CHECK(queue.wait_pop(stop_source.get_token(), value));
+      ordered &= value > last[value / count];
+      last[value / count] = value;
+    }
+    CHECK(ordered);
+  }
+  {
+    xstd::task_thread thread{};
+    std::atomic<int> sum{};
+    {
+      std::vector<std::jthread> threads{};
+      for (int p = 0; p < 4; ++p)
+        threads.emplace_back([&] {
+          for (int i = 0; i < 1000; ++i)
+            thread.async_invoke_and_discard([&] { ++sum; });
+        });
+    }
+    CHECK(thread.invoke([&] { return sum.load(); }) == 4000);
+  }
+}
+
+SCENARIO("xstd::spsc_ring_buffer") {
+  {
+    xstd::spsc_ring_buffer<std::unique_ptr<int>> queue{3};
+    CHECK(queue.capacity() == 4);
+    std::unique_ptr<int> value{};
+    CHECK(not queue.try_pop(value));
+    for (int i = 0; i < 4; ++i) CHECK(queue.try_push(std::make_unique<int>(i)));
+    CHECK(not queue.try_push(std::make_unique<int>(4)));
+    for (int i = 0; i < 2; ++i) {
+      CHECK(queue.try_pop(value));
+      CHECK(*value == i);
+    }
+    // Remaining elements wrap around and are destroyed with the queue.
+    CHECK(queue.try_push(std::make_unique<int>(4)));
+  }
+  {
+    xstd::spsc_ring_buffer<int> queue{8};
+    queue.push_range(std::views::iota(0, 6));
+    std::array<int, 4> buffer{};
+    CHECK(queue.try_pop_range(buffer) == 4);
+    CHECK(buffer == std::array{0, 1, 2, 3});
+    queue.push_range(std::views::iota(6, 12));
+    CHECK(queue.try_pop_range(buffer) == 4);
+    CHECK(buffer == std::array{4, 5, 6, 7});
+    CHECK(queue.try_pop_range(buffer) == 4);
+    CHECK(queue.try_pop_range(buffer) == 0);
+  }
+  {
+    constexpr int count = 100'000;
+    xstd::spsc_ring_buffer<int> queue{64};
+    std::jthread producer{[&] {
+      for (int i = 0; i < count / 2; ++i) queue.push(int{i});
+      queue.push_range(std::views::iota(count / 2, count));
+    }};
+    std::stop_source stop_source{};
+    bool ordered = true;
+    for (int i = 0; i < count; ++i) {
+      int value;
+      CHECK(queue.wait_pop(stop_source.get_token(), value));
+      ordered &= value == i;
+    }
+    CHECK(ordered);
+  }
+  {
+    xstd::spsc_task_thread thread{16};
+    int sum = 0;
+    for (int i = 0; i < 1000; ++i)
+      thread.async_invoke_and_discard([&sum, i] { sum += i; });
+    CHECK(thread.invoke([&] { return sum; }) == 499500);
+  }
+}
+
+SCENARIO("xstd::thread_placement") {
+  const auto topology = xstd::cpu_topology();
+  CHECK(not topology.empty());
+  const auto cores = xstd::physical_cores();
+  CHECK(not cores.empty());
+  CHECK(cores.size() <= topology.size());
+  CHECK(xstd::physical_core_placements("pool").size() == cores.size());
+
+  const auto affinity = xstd::current_thread_affinity();
+  if (affinity.empty()) return;
+  const auto cpu = affinity.back();
+  {
+    xstd::scoped_thread_affinity guard{std::array{cpu}};
+    CHECK(xstd::current_thread_affinity() == std::vector{cpu});
+  }
+  CHECK(xstd::current_thread_affinity() == affinity);
+
+  xstd::task_thread thread{xstd::thread_placement{"xstd-test", {cpu}}};
+  CHECK(thread.invoke([] { return xstd::current_thread_affinity(); }) ==
+        std::vector{cpu});
+
+  xstd::thread_pool pool{{{"xstd-pool/0", {cpu}}, {"xstd-pool/1", {cpu}}}};
+  CHECK(pool.size() == 2);
+  CHECK(pool.async_invoke([] { return xstd::current_thread_affinity(); })
+            .get() == std::vector{cpu});
+}
+
+SCENARIO("xstd::bounded_queue") {
+  {
+    xstd::bounded_queue<int> queue{2};
+    int value{};
+    CHECK(queue.try_push(1));
+    CHECK(queue.try_push(2));
+    CHECK(not queue.try_push(3));
+    CHECK(queue.size() == 2);
+    CHECK(queue.bytes() == 2 * sizeof(int));
+    std::stop_source stop_source{};
+    stop_source.request_stop();
+    CHECK(not queue.wait_push(stop_source.get_token(), 3));
+    CHECK(queue.try_pop(value));
+    CHECK(value == 1);
+    CHECK(queue.wait_push(std::stop_token{}, 3));
+  }
+  {
+    xstd::bounded_queue<int> queue{2, xstd::overflow_policy::drop_oldest};
+    for (int i = 0; i < 5; ++i) queue.push(int{i});
+    CHECK(queue.dropped() == 3);
+    std::array<int, 4> buffer{};
+    CHECK(queue.try_pop_range(buffer) == 2);
+    CHECK(buffer[0] == 3);
+    CHECK(buffer[1] == 4);
+  }
+  {
+    xstd::bounded_queue<int> queue{2, xstd::overflow_policy::drop_newest};
+    for (int i = 0; i < 5; ++i) queue.push(int{i});
+    CHECK(queue.dropped() == 3);
+    int value{};
+    CHECK(queue.try_pop(value));
+    CHECK(value == 0);
+  }
+  {
+    // The capacity in bytes accounts for the footprint of elements.
+    xstd::bounded_queue<int> queue{100, xstd::overflow_policy::block, 64};
+    CHECK(queue.try_push(xstd::footprint{32}, 1));
+    CHECK(not queue.try_push(xstd::footprint{32}, 2));
+    CHECK(queue.try_push(2));
+    // An element always fits into an empty queue.
+    xstd::bounded_queue<int> other{1, xstd::overflow_policy::block, 1};
+    CHECK(other.try_push(xstd::footprint{1000}, 1));
+  }
+  {
+    // Blocked producers are released by consumers.
+    constexpr int count = 10'000;
+    xstd::bounded_queue<int> queue{4};
+    std::jthread producer{[&] {
+      for (int i = 0; i < count; ++i) queue.push(int{i});
+    }};
+    bool ordered = true;
+    for (int i = 0; i < count; ++i) {
+      int value;
+      CHECK(queue.wait_pop(std::stop_token{}, value));
+      ordered &= value == i;
+    }
+    CHECK(ordered);
+  }
+  {
+    xstd::bounded_task_queue tasks{1, xstd::overflow_policy::drop_oldest};
+    auto first  = tasks.push([] { return 1; });
+    auto second = tasks.push([] { return 2; });
+    CHECK_THROWS_AS(first.get(), std::future_error);
+    CHECK(not tasks.try_push_and_discard([] {}));
+    CHECK(not tasks.try_push([] { return 3; }));
+    std::stop_source stop_source{};
+    stop_source.request_stop();
+    CHECK(not tasks.wait_push(stop_source.get_token(), [] { return 3; }));
+    tasks.process_all();
+    CHECK(second.get() == 2);
+    auto third = tasks.wait_push(std::stop_token{}, [] { return 3; });
+    CHECK(third.has_value());
+    tasks.process_all();
+    CHECK(third->get() == 3);
+    if constexpr (xstd::instrumentation_enabled) {
+      const auto stats = tasks.stats();
+      CHECK(stats.discarded == 4);
+      CHECK(stats.depth == 0);
+    }
+  }
+  {
+    // Captured state counts towards the capacity in bytes.
+    xstd::bounded_task_queue tasks{100, xstd::overflow_policy::block, 256};
+    std::array<char, 512> large{};
+    CHECK(tasks.try_push_and_discard([large] { std::ignore = large; }));
+    CHECK(not tasks.try_push_and_discard([large] { std::ignore = large; }));
+    tasks.process_all();
+  }
+  {
+    // Forced pushes ignore the capacity and closing makes pushes fail.
+    xstd::bounded_queue<int> queue{1};
+    queue.push(0);
+    CHECK(queue.force_push(1));
+    CHECK(queue.size() == 2);
+    std::jthread producer{[&] { CHECK(queue.push(2) == 1); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    queue.close();
+    producer.join();
+    CHECK(queue.is_closed());
+    CHECK(not queue.try_push(3));
+    CHECK(not queue.force_push(3));
+    CHECK(not queue.wait_push(std::stop_token{}, 3));
+    int value;
+    CHECK(queue.try_pop(value));
+    CHECK(value == 0);
+  }
+  {
+    // Producers blocked on a full task thread return once it has stopped.
+    xstd::bounded_task_thread thread{1};
+    std::latch started{1};
+    std::latch release{1};
+    thread.push_and_discard([&] {
+      started.count_down();
+      release.wait();
+    });
+    started.wait();
+    thread.push_and_discard([] {});
+    std::future<int> blocked{};
+    std::jthread producer{[&] { blocked = thread.push([] { return 1; }); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    thread.request_stop();
+    release.count_down();
+    producer.join();
+    CHECK_THROWS_AS(blocked.get(), std::future_error);
+  }
+  {
+    // Timer insertions and cancellations are never dropped by the policy.
+    using namespace std::chrono_literals;
+    xstd::bounded_task_thread thread{1, xstd::overflow_policy::drop_newest};
+    std::latch started{1};
+    std::latch release{1};
+    thread.push_and_discard([&] {
+      started.count_down();
+      release.wait();
+    });
+    started.wait();
+    thread.push_and_discard([] {});
+    auto delayed     = thread.async_invoke_after(1ms, [] { return 7; });
+    const auto guard = std::make_shared<int>(0);
+    auto timeout     = thread.invoke_after(1h, [guard] {});
+    CHECK(thread.cancel(timeout));
+    release.count_down();
+    CHECK(delayed.get() == 7);
+    thread.invoke([] {});
+    CHECK(guard.use_count() == 1);
+  }
+}
+
+SCENARIO("xstd::timer_wheel") {
+  using namespace std::chrono_literals;
+  using clock_type = std::chrono::steady_clock;
+  const auto start = clock_type::now();
+  {
+    xstd::timer_wheel<int> wheel{1ms, start};
+    CHECK(wheel.empty());
+    CHECK(not wheel.next_deadline());
+    std::vector<int> expired{};
+    const auto collect = [&](int value) { expired.push_back(value); };
+    // Timers of all levels, beyond the last level, and already expired ones.
+    const std::array<clock_type::duration, 6> delays{
+        5ms, 70ms, 5s, 2h, 100h, 0ms};
+    for (int i = 0; i < int(delays.size()); ++i)
+      wheel.insert(start + delays[i], int{i});
+    const auto cancelled = wheel.insert(start + 3ms, 99);
+    CHECK(wheel.size() == 7);
+    CHECK(wheel.cancel(cancelled));
+    CHECK(not wheel.cancel(cancelled));
+    CHECK(not wheel.contains(cancelled));
+
+    CHECK(wheel.next_deadline() == start);
+    CHECK(wheel.expire(start, collect) == 1);
+    CHECK(expired == std::vector{5});
+    // Timers never expire early.
+    CHECK(wheel.expire(start + 4ms, collect) == 0);
+    CHECK(wheel.expire(start + 5ms, collect) == 1);
+    CHECK(wheel.expire(start + 69ms, collect) == 0);
+    CHECK(wheel.expire(start + 70ms, collect) == 1);
+    CHECK(wheel.expire(start + 1h, collect) == 1);
+    CHECK(wheel.expire(start + 2h - 1ms, collect) == 0);
+    CHECK(wheel.expire(start + 2h, collect) == 1);
+    CHECK(wheel.expire(start + 100h - 1ms, collect) == 0);
+    CHECK(wheel.expire(start + 100h, collect) == 1);
+    CHECK(expired == std::vector{5, 0, 1, 2, 3, 4});
+    CHECK(wheel.empty());
+  }
+  {
+    // Timers inserted while expiring and with equal deadlines in FIFO order.
+    xstd::timer_wheel<std::function<void()>> wheel{1ms, start};
+    std::vector<int> order{};
+    for (int i = 0; i < 3; ++i)
+      wheel.insert(start + 10ms, [&, i] {
+        order.push_back(i);
+        if (i == 0) wheel.insert(start, [&] { order.push_back(3); });
+      });
+    wheel.expire(start + 10ms, [](auto&& f) { f(); });
+    CHECK(order == std::vector{0, 1, 2, 3});
+  }
+  {
+    // The most extreme deadlines saturate instead of overflowing.
+    xstd::timer_wheel<int> wheel{1ms, start};
+    std::vector<int> expired{};
+    const auto collect = [&](int value) { expired.push_back(value); };
+    wheel.insert(clock_type::time_point::max(), 0);
+    wheel.insert(clock_type::time_point::min(), 1);
+    CHECK(wheel.expire(clock_type::time_point::min(), collect) == 1);
+    CHECK(wheel.expire(start + 100h, collect) == 0);
+    CHECK(expired == std::vector{1});
+    CHECK(wheel.size() == 1);
+  }
+  {
+    // The wheel copes with many pending timers at constant cost per timer.
+    xstd::timer_wheel<int> wheel{1ms, start};
+    std::vector<xstd::timer_wheel<int>::timer_id> ids{};
+    for (int i = 0; i < 100'000; ++i)
+      ids.push_back(wheel.insert(start + i * 1ms, int{i}));
+    for (int i = 0; i < 100'000; i += 2) wheel.cancel(ids[i]);
+    int last = -1;
+    bool ordered = true;
+    const auto count = wheel.expire(start + 100s, [&](int value) {
+      ordered &= (value > last) && (value % 2 == 1);
+      last = value;
+    });
+    CHECK(count == 50'000);
+    CHECK(ordered);
+  }
+  {
+    xstd::task_thread thread{};
+    const auto begin = clock_type::now();
+    auto delayed = thread.async_invoke_after(20ms, [] { return 7; });
+    // The thread keeps processing other tasks in the meantime.
+    CHECK(thread.invoke([] { return 1; }) == 1);
+    CHECK(delayed.get() == 7);
+    CHECK(clock_type::now() - begin >= 20ms);
+    auto absolute = thread.async_invoke_at(clock_type::now() + 1ms,
+                                           [](int x) { return x; }, 3);
+    CHECK(absolute.get() == 3);
+
+    std::atomic<int> ticks{};
+    auto stop_source = thread.invoke_every(1ms, [&] { ++ticks; });
+    while (ticks < 5) std::this_thread::sleep_for(1ms);
+    stop_source.request_stop();
+    thread.invoke([] {});
+    const int final_ticks = ticks;
+    std::this_thread::sleep_for(5ms);
+    CHECK(ticks <= final_ticks + 1);
+  }
+  {
+    // Cancelled timeouts are removed from the wheel before their deadline.
+    xstd::task_thread thread{};
+    const auto guard = std::make_shared<int>(0);
+    auto timeout     = thread.invoke_after(1h, [guard] { *guard = 1; });
+    CHECK(timeout.pending());
+    CHECK(thread.cancel(timeout));
+    CHECK(not thread.cancel(timeout));
+    CHECK(not timeout.pending());
+    thread.invoke([] {});
+    CHECK(guard.use_count() == 1);
+    CHECK(not thread.cancel(xstd::timer_handle{}));
+
+    // Timers may also be cancelled on the task thread itself.
+    std::atomic<bool> invoked{};
+    auto handle = thread.invoke_at(clock_type::now() + 1h,
+                                   [guard, &invoked] { invoked = true; });
+    CHECK(thread.invoke([&] { return thread.cancel(handle); }));
+    CHECK(guard.use_count() == 1);
+
+    // Expired timers cannot be cancelled anymore.
+    auto expired = thread.invoke_after(1ms, [&] { invoked = true; });
+    while (not invoked) std::this_thread::sleep_for(1ms);
+    CHECK(not expired.pending());
+    CHECK(not thread.cancel(expired));
+  }
+}
+
+SCENARIO("xstd::task cancellation and draining") {
+  {
+    xstd::task_queue tasks{};
+    int invoked = 0;
+    const auto f   = [&] { return ++invoked; };
+    auto cancelled = tasks.push(xstd::use_task_future, f);
+    auto kept      = tasks.push(xstd::use_task_future, f);
+    CHECK(cancelled.cancel());
+    CHECK(not cancelled.cancel());
+    CHECK(cancelled.is_ready());
+    CHECK_THROWS_AS(cancelled.get(), xstd::task_cancelled);
+    // Cancelled tasks stay in the queue but are skipped.
+    tasks.process_all();
+    CHECK(invoked == 1);
+    CHECK(not kept.cancel());
+    CHECK(kept.get() == 1);
+  }
+  {
+    xstd::task_thread thread{};
+    auto future = thread.async_invoke(xstd::use_task_future, [] { return 1; });
+    future.wait();
+    CHECK(not future.cancel());
+    CHECK(future.get() == 1);
+  }
+  {
+    struct tagged_task {
+      void operator()() { std::invoke(f); }
+      int tag{};
+      std::move_only_function<void()> f{};
+    };
+    xstd::generic_task_queue<xstd::locked_queue<tagged_task>> tasks{};
+    std::vector<int> order{};
+    for (int i = 0; i < 6; ++i)
+      tasks.get_container().push({i, [&, i] { order.push_back(i); }});
+    CHECK(tasks.cancel_if([](const tagged_task& x) { return x.tag % 2; }) == 3);
+    CHECK(tasks.cancel_if([](const tagged_task&) { return false; }) == 0);
+    tasks.process_all();
+    CHECK(order == std::vector{0, 2, 4});
+  }
+  {
+    xstd::priority_task_queue tasks{};
+    auto low  = tasks.push(0, [] {});
+    auto high = tasks.push(3, [] {});
+    CHECK(tasks.cancel_if([](auto&) { return true; }) == 2);
+    CHECK(not tasks.process());
+    CHECK_THROWS_AS(low.get(), std::future_error);
+    CHECK_THROWS_AS(high.get(), std::future_error);
+
+    xstd::bounded_queue<int> queue{4};
+    for (int i = 0; i < 4; ++i) queue.push(int{i});
+    CHECK(queue.remove_if([](int x) { return x < 2; }) == 2);
+    CHECK(queue.size() == 2);
+    CHECK(queue.bytes() == 2 * sizeof(int));
+
+    xstd::deadline_queue<int> deadlines{};
+    const auto now = std::chrono::steady_clock::now();
+    for (int i = 0; i < 5; ++i)
+      deadlines.push(now + std::chrono::seconds{5 - i}, int{i});
+    CHECK(deadlines.remove_if([](int x) { return x == 1 || x == 3; }) == 2);
+    std::vector<int> order{};
+    for (int x; deadlines.try_pop(x);) order.push_back(x);
+    CHECK(order == std::vector{4, 2, 0});
+  }
+  {
+    // Draining finishes all enqueued tasks before stopping.
+    xstd::task_thread thread{};
+    std::atomic<int> count{};
+    for (int i = 0; i < 1000; ++i)
+      thread.async_invoke_and_discard([&] {
+        std::this_thread::sleep_for(std::chrono::microseconds{1});
+        ++count;
+      });
+    thread.drain_and_stop();
+    CHECK(count == 1000);
+
+    xstd::thread_pool pool{4};
+    std::atomic<int> nested{};
+    for (int i = 0; i < 100; ++i)
+      pool.async_invoke_and_discard([&] {
+        for (int j = 0; j < 10; ++j)
+          pool.async_invoke_and_discard([&] { ++nested; });
+      });
+    pool.drain_and_stop();
+    CHECK(nested == 1000);
+  }
+}
+
+SCENARIO("xstd parallel algorithms") {
+  xstd::thread_pool pool{4};
+  std::vector<std::int64_t> values(100'000);
+  std::iota(values.begin(), values.end(), 1);
+
+  xstd::parallel_for(pool, values, [](auto& x) { x *= 2; });
+  CHECK(values[0] == 2);
+  CHECK(values.back() == 200'000);
+
+  const auto sum =
+      xstd::parallel_reduce(pool, values, std::int64_t{0}, std::plus{});
+  CHECK(sum == 100'000LL * 100'001);
+  // The reduction respects the order of elements for non-commutative ones.
+  std::vector<std::string> words{"a", "b", "c", "d", "e", "f", "g"};
+  CHECK(xstd::parallel_reduce(pool, words, std::string{">"}, std::plus{},
+                              {.grain = 2}) == ">abcdefg");
+
+  std::vector<double> roots(values.size());
+  const auto end = xstd::parallel_transform(
+      pool, values, roots.begin(), [](auto x) { return std::sqrt(double(x)); });
+  CHECK(end == roots.end());
+  CHECK(roots[7] == std::sqrt(16.0));
+
+  std::vector<std::int64_t> prefix(values.size());
+  xstd::parallel_scan(pool, values, prefix.begin(), std::int64_t{5},
+                      std::plus{}, {.grain = 1000});
+  std::vector<std::int64_t> expected(values.size());
+  std::inclusive_scan(values.begin(), values.end(), expected.begin(),
+                      std::plus{}, std::int64_t{5});
+  CHECK(prefix == expected);
+  // The scan also works in place and for empty ranges.
+  xstd::parallel_scan(pool, values, values.begin(), std::int64_t{5},
+                      std::plus{});
+  CHECK(values == expected);
+  std::vector<int> empty{};
+  CHECK(xstd::parallel_scan(pool, empty, empty.begin(), 0, std::plus{}) ==
+        empty.begin());
+
+  std::mt19937 rng{42};
+  for (const auto n : {0, 1, 1000, 5000, 100'000}) {
+    std::vector<int> data(n);
+    for (auto& x : data) x = std::uniform_int_distribution{0, 1000}(rng);
+    auto reference = data;
+    std::ranges::sort(reference);
+    xstd::parallel_sort(pool, data);
+    CHECK(data == reference);
+    std::ranges::shuffle(data, rng);
+    xstd::parallel_sort(pool, data, std::ranges::greater{}, {.grain = 1024});
+    CHECK(std::ranges::is_sorted(data, std::ranges::greater{}));
+  }
+  {
+    // Index ranges and executors that are only processed by the caller.
+    xstd::task_queue tasks{};
+    std::vector<int> squares(1000);
+    xstd::parallel_for(
+        tasks, std::views::iota(0, 1000), [&](int i) { squares[i] = i * i; },
+        {.grain = 10});
+    CHECK(squares[999] == 999 * 999);
+    xstd::task_thread thread{};
+    CHECK(xstd::parallel_reduce(thread, std::views::iota(1, 101), 0,
+                                std::plus{}) == 5050);
+  }
+  {
+    // The first exception is rethrown after all chunks have been finished.
+    std::atomic<int> processed{};
+    CHECK_THROWS_AS(xstd::parallel_for(pool, std::views::iota(0, 1000),
+                                       [&](int i) {
+                                         ++processed;
+                                         if (i == 500)
+                                           throw std::runtime_error{"fail"};
+                                       }),
+                    std::runtime_error);
+    CHECK(processed <= 1000);
+    // Nested algorithms on workers do not deadlock.
+    std::atomic<int> total{};
+    xstd::parallel_for(pool, std::views::iota(0, 8), [&](int) {
+      total += xstd::parallel_reduce(pool, std::views::iota(0, 100), 0,
+                                     std::plus{}, {.grain = 10});
+    }, {.grain = 1});
+    CHECK(total == 8 * 4950);
+  }
+}
+
+SCENARIO("xstd::task_graph") {
+  xstd::thread_pool pool{4};
+  {
+    // Diamond with an additional chain that is executed repeatedly.
+    xstd::task_graph graph{};
+    std::array<std::atomic<int>, 6> order{};
+    std::atomic<int> clock{};
+    const auto stamp = [&](int i) {
+      return [&, i] { order[i] = ++clock; };
+    };
+    const auto a = graph.emplace(stamp(0));
+    const auto b = graph.emplace(stamp(1));
+    const auto c = graph.emplace(stamp(2));
+    const auto d = graph.emplace(stamp(3));
+    const auto e = graph.emplace(stamp(4));
+    const auto f = graph.emplace(stamp(5));
+    graph.precede(a, b);
+    graph.precede(a, c);
+    graph.precede(b, d);
+    graph.precede(c, d);
+    graph.precede(d, e);
+    CHECK(graph.size() == 6);
+    CHECK(graph.edge_count() == 5);
+    for (int run = 0; run < 100; ++run) {
+      clock = 0;
+      graph.run(pool);
+      CHECK(clock == 6);
+      CHECK(order[0] < order[1]);
+      CHECK(order[0] < order[2]);
+      CHECK(order[1] < order[3]);
+      CHECK(order[2] < order[3]);
+      CHECK(order[3] < order[4]);
+      CHECK(order[5] > 0);
+    }
+    // The graph can be extended between runs.
+    const auto g = graph.emplace([&] { ++clock; });
+    graph.precede(e, g);
+    graph.precede(f, g);
+    clock = 0;
+    graph.run(pool);
+    CHECK(clock == 7);
+  }
+  {
+    // Wide fan-out and fan-in with results of many nodes.
+    xstd::task_graph graph{};
+    std::vector<int> values(1000);
+    std::int64_t sum = 0;
+    const auto source = graph.emplace([] {});
+    const auto sink   = graph.emplace([&] {
+      sum = std::accumulate(values.begin(), values.end(), std::int64_t{});
+    });
+    for (int i = 0; i < 1000; ++i) {
+      const auto node = graph.emplace([&values, i] { values[i] += i; });
+      graph.precede(source, node);
+      graph.precede(node, sink);
+    }
+    graph.run(pool);
+    graph.run(pool);
+    CHECK(sum == 2 * 999 * 1000 / 2);
+    // Other executors can run the same graph as well.
+    xstd::task_thread thread{};
+    graph.run(thread);
+    CHECK(sum == 3 * 999 * 1000 / 2);
+  }
+  {
+    xstd::task_graph graph{};
+    std::atomic<int> count{};
+    const auto a = graph.emplace([] { throw std::runtime_error{"fail"}; });
+    const auto b = graph.emplace([&] { ++count; });
+    const auto c = graph.emplace([&] { ++count; });
+    graph.precede(a, b);
+    graph.precede(b, c);
+    CHECK_THROWS_AS(graph.run(pool), std::runtime_error);
+    CHECK(count == 0);
+    graph.precede(c, a);
+    CHECK_THROWS_AS(graph.run(pool), std::invalid_argument);
+  }
+}
+
+namespace {
+
+// Executor that fails to enqueue any task, like a full bounded queue.
+struct refusing_executor {
+  void async_invoke_and_discard(auto&&) {
+    ++calls;
+    throw std::bad_alloc{};
+  }
+  int calls = 0;
+};
+
+}  // namespace
+
+SCENARIO("xstd::strand") {
+  xstd::thread_pool pool{4};
+  {
+    // Tasks of a strand are processed in FIFO order and never concurrently.
+    xstd::strand strand{pool};
+    std::vector<int> order{};
+    std::atomic<int> running{};
+    bool overlapped = false;
+    for (int i = 0; i < 1000; ++i)
+      strand.async_invoke_and_discard([&, i] {
+        overlapped |= (++running > 1);
+        order.push_back(i);
+        --running;
+      });
+    CHECK(strand.invoke([&] { return order.size(); }) == 1000);
+    CHECK(not overlapped);
+    std::vector<int> expected(1000);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(order == expected);
+  }
+  {
+    // Many strands share the pool and multiple producers push concurrently.
+    using strand_type = xstd::strand<xstd::thread_pool>;
+    std::vector<std::unique_ptr<strand_type>> strands{};
+    std::vector<int> counters(100);
+    for (int i = 0; i < 100; ++i)
+      strands.push_back(std::make_unique<strand_type>(pool));
+    std::vector<std::jthread> producers{};
+    for (int p = 0; p < 4; ++p)
+      producers.emplace_back([&] {
+        for (int k = 0; k < 100; ++k)
+          for (int i = 0; i < 100; ++i)
+            strands[i]->async_invoke_and_discard([&, i] { ++counters[i]; });
+      });
+    producers.clear();
+    for (int i = 0; i < 100; ++i)
+      CHECK(strands[i]->invoke([&, i] { return counters[i]; }) == 400);
+  }
+  {
+    // Invoking the strand from one of its tasks does not block.
+    xstd::strand strand{pool};
+    CHECK(not strand.running_in_this_thread());
+    auto nested = strand.async_invoke([&] {
+      return strand.running_in_this_thread() &&
+             strand.invoke([] { return 42; }) == 42;
+    });
+    CHECK(nested.get());
+    CHECK(strand.invoke<double>([](int x) { return x; }, 3) == 3.0);
+    auto future = strand.async_invoke(xstd::use_task_future,
+                                      [](int x) { return x + 1; }, 1);
+    CHECK(future.get() == 2);
+    // A strand can also run on a single task thread.
+    xstd::task_thread thread{};
+    xstd::strand serial{thread};
+    CHECK(serial.invoke([&] { return thread.get_id(); }) == thread.get_id());
+  }
+  {
+    // The destructor waits for all pending tasks.
+    std::atomic<int> done{};
+    {
+      xstd::strand strand{pool};
+      for (int i = 0; i < 200; ++i)
+        strand.async_invoke_and_discard([&] {
+          std::this_thread::sleep_for(std::chrono::microseconds{10});
+          ++done;
+        });
+    }
+    CHECK(done == 200);
+  }
+  {
+    // An executor that refuses the draining does not wedge the strand.
+    refusing_executor executor{};
+    int done = 0;
+    {
+      xstd::strand strand{executor};
+      for (int i = 0; i < 100; ++i)
+        strand.async_invoke_and_discard([&] { ++done; });
+      CHECK(done == 100);
+    }
+    CHECK(executor.calls == 100);
+  }
+}
+
+SCENARIO("xstd::task_thread synchronous invocation") {
+  xstd::task_thread thread{};
+  {
+    int value = 1;
+    CHECK(thread.invoke([](int x, int y) { return x + y; }, 1, 2) == 3);
+    CHECK(thread.invoke([&]() -> int& { return value; }) == 1);
+    thread.invoke([&] { value = 2; });
+    CHECK(value == 2);
+    CHECK(*thread.invoke([] { return std::make_unique<int>(4); }) == 4);
+    CHECK(thread.invoke<double>([](int x) { return x; }, 3) == 3.0);
+    const auto fail = []() -> int { throw std::runtime_error{""}; };
+    CHECK_THROWS_AS(thread.invoke(fail), std::runtime_error);
+  }
+  {
+    // A discarded invocation does not block its caller forever.
+    xstd::task_queue tasks{};
+    std::jthread caller{[&] {
+      CHECK_THROWS_AS(tasks.invoke([] { return 1; }), std::future_error);
+    }};
+    while (not tasks.cancel_if([](auto&) { return true; }))
+      std::this_thread::yield();
+  }
+  {
+    // The task of an invocation is pushed with a node of the caller.
+    xstd::mpsc_task_queue tasks{};
+    std::jthread worker{[&](std::stop_token stop_token) {
+      tasks.run(stop_token);
+    }};
+    int value = 1;
+    CHECK(tasks.invoke([](int x, int y) { return x + y; }, 1, 2) == 3);
+    tasks.invoke([&] { value = 2; });
+    CHECK(value == 2);
+    const auto fail = []() -> int { throw std::runtime_error{""}; };
+    CHECK_THROWS_AS(tasks.invoke(fail), std::runtime_error);
+  }
+  {
+    xstd::mpsc_task_queue tasks{};
+    std::jthread caller{[&] {
+      CHECK_THROWS_AS(tasks.invoke([] { return 1; }), std::future_error);
+    }};
+    std::move_only_function<void()> task{};
+    while (not tasks.get_container().try_pop(task)) std::this_thread::yield();
+    task = nullptr;
+  }
+}
+
+SCENARIO("xstd::async_pool") {
+  {
+    auto future = xstd::pooled_async_invoke([](int x, int y) { return x + y; },
+                                            1, 2);
+    CHECK(future.get() == 3);
+    const auto fail = [] { throw std::runtime_error{""}; };
+    CHECK_THROWS_AS(xstd::pooled_async_invoke(fail).get(), std::runtime_error);
+    CHECK(xstd::default_async_pool().size() >= 1);
+  }
+  {
+    // Workers are only started on demand and never exceed the maximum.
+    xstd::async_pool pool{2};
+    CHECK(pool.max_size() == 2);
+    CHECK(pool.size() == 0);
+    std::vector<std::future<int>> results{};
+    for (int i = 0; i < 100; ++i)
+      results.push_back(pool.async_invoke([](int x) { return x; }, i));
+    for (int i = 0; i < 100; ++i) CHECK(results[i].get() == i);
+    CHECK(pool.size() >= 1);
+    CHECK(pool.size() <= 2);
+  }
+  const auto blocked = [](std::latch& release) {
+    release.wait();
+    return std::this_thread::get_id();
+  };
+  {
+    // By default, overflowing calls do not wait for busy workers.
+    xstd::async_pool pool{1};
+    std::latch release{1};
+    auto first  = pool.async_invoke(blocked, std::ref(release));
+    auto second = pool.async_invoke([] { return std::this_thread::get_id(); });
+    CHECK(second.get() != std::this_thread::get_id());
+    release.count_down();
+    CHECK(first.get() != std::this_thread::get_id());
+    CHECK(pool.size() == 1);
+  }
+  {
+    xstd::async_pool pool{1, xstd::async_overflow_policy::enqueue};
+    std::latch release{1};
+    auto first  = pool.async_invoke(blocked, std::ref(release));
+    auto second = pool.async_invoke([] { return std::this_thread::get_id(); });
+    CHECK(second.wait_for(std::chrono::milliseconds{10}) ==
+          std::future_status::timeout);
+    release.count_down();
+    CHECK(first.get() == second.get());
+  }
+  {
+    xstd::async_pool pool{1, xstd::async_overflow_policy::run_inline};
+    std::latch release{1};
+    auto first  = pool.async_invoke(blocked, std::ref(release));
+    auto second = pool.async_invoke([] { return std::this_thread::get_id(); });
+    CHECK(second.get() == std::this_thread::get_id());
+    release.count_down();
+    CHECK(first.get() != std::this_thread::get_id());
+  }
+  {
+    // Running tasks may still make calls while the pool is destroyed.
+    auto pool = std::make_unique<xstd::async_pool>(
+        1, xstd::async_overflow_policy::enqueue);
+    std::atomic<int> nested{};
+    std::ignore = pool->async_invoke([&nested, raw = pool.get()] {
+      // Workers are taken over by the destructor first.
+      while (raw->size() != 0) std::this_thread::yield();
+      for (int i = 0; i < 10; ++i)
+        std::ignore = raw->async_invoke([&nested] { ++nested; });
+    });
+    pool.reset();
+    CHECK(nested == 10);
+  }
+}
+
+namespace {
+
+struct ping {
+  int value{};
+};
+struct pong {
+  explicit pong(std::string s) : text{std::move(s)} {}
+  std::string text;
+};
+struct stop {};
+
+}  // namespace
+
+SCENARIO("xstd::message_queue") {
+  using xstd::meta::type_list;
+  static_assert(xstd::message_set<type_list<ping, pong, stop>>);
+  static_assert(not xstd::message_set<type_list<>>);
+  static_assert(not xstd::message_set<type_list<ping, ping>>);
+  static_assert(not xstd::message_set<type_list<ping&>>);
+  static_assert(not xstd::message_set<type_list<const ping>>);
+  static_assert(not xstd::message_set<type_list<std::monostate>>);
+
+  using queue_type = xstd::message_queue<ping, pong, stop>;
+  static_assert(xstd::message_of<pong, queue_type::message_list>);
+  static_assert(not xstd::message_of<int, queue_type::message_list>);
+  using partial_handler = decltype(xstd::match{[](ping&) {}});
+  static_assert(not xstd::message_handler_for<partial_handler,
+                                              queue_type::message_list>);
+  {
+    queue_type messages{4};
+    CHECK(messages.capacity() == 4);
+    int sum = 0;
+    std::string text{};
+    int stops = 0;
+    const auto handler = xstd::match{
+        [&](ping& p) { sum += p.value; },
+        [&](pong& p) { text = std::move(p.text); },
+        [&](stop&) { ++stops; },
+    };
+    CHECK(not messages.process(handler));
+    messages.push(ping{1});
+    messages.emplace<pong>("hello");
+    CHECK(messages.try_push(ping{2}));
+    CHECK(messages.try_push(stop{}));
+    CHECK(not messages.try_push(ping{3}));
+    CHECK(messages.process_all(handler) == 4);
+    CHECK(sum == 3);
+    CHECK(text == "hello");
+    CHECK(stops == 1);
+  }
+  {
+    // An actor thread processes the messages of multiple senders in order.
+    constexpr int count = 10'000;
+    queue_type messages{64};
+    std::vector<int> last(2, -1);
+    bool ordered = true;
+    std::atomic<int> stops{};
+    std::jthread actor{[&](std::stop_token stop_token) {
+      messages.run(stop_token, xstd::match{
+                                   [&](ping& p) {
+                                     auto& previous = last[p.value % 2];
+                                     ordered &= previous < p.value;
+                                     previous = p.value;
+                                   },
+                                   [](pong&) {},
+                                   [&](stop&) { ++stops; },
+                               });
+    }};
+    std::vector<std::jthread> senders{};
+    for (int s = 0; s < 2; ++s)
+      senders.emplace_back([&, s] {
+        for (int i = s; i < 2 * count; i += 2) messages.push(ping{i});
+        messages.push(stop{});
+      });
+    senders.clear();
+    while (stops < 2) std::this_thread::yield();
+    actor.request_stop();
+    actor.join();
+    CHECK(ordered);
+    CHECK(last[0] == 2 * count - 2);
+    CHECK(last[1] == 2 * count - 1);
+  }
+}